@@ -20,6 +20,12 @@
 /// platforms.                                                               ///
 /// See @a util/SoftwareTimer.h header file.                                 ///
 ///                                                                          ///
+/// A child timer allows sharing a timer between several logical timers.     ///
+/// See @a util/ChildTimer.h header file.                                    ///
+///                                                                          ///
+/// Calendar tickets are executed at times given by a cron-like rule.        ///
+/// See @a util/CalendarTicket.h header file.                                ///
+///                                                                          ///
 /// @section DEPENDENCIES                                                    ///
 /// SRUtilLib library for delegates                                          ///
 /// UtilLib library for time and utility related functions.                  ///
@@ -0,0 +1,106 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @section LICENSE                                                         ///
+///                                                                          ///
+///        Distributed under the Boost Software License, Version 1.0.        ///
+///             (See accompanying file LICENSE_1_0.txt or copy at            ///
+///                  http://www.boost.org/LICENSE_1_0.txt)                   ///
+///                                                                          ///
+/// @file                                                                    ///
+/// @author  Alejandro Morell Garcia <alejandro.morell@gmail.com>            ///
+/// @version 1.0                                                             ///
+////////////////////////////////////////////////////////////////////////////////
+
+#include <TimerLib.h>
+#include <UtilLib.h>
+#include <SRUtilLib.h>
+
+#include <util/SoftwareTimer.h>
+#include <util/CalendarTicket.h>
+using util::SoftwareTimer;
+using util::CalendarRule;
+using util::CalendarTicket;
+using util::WallClock;
+SoftwareTimer timer;
+
+// Sunday 18 October 2026 12:00:00. Usually it is read from a RTC or NTP.
+const WallClock::epoch_t START_TIME = 1792324800UL;
+
+WallClock wallClock;
+CalendarRule everyMinute, nightly;
+CalendarTicket minuteTicket, nightlyTicket;
+
+void checkRule(const char *expr, WallClock::epoch_t after, WallClock::epoch_t expected);
+void printTime(WallClock::epoch_t time);
+void minuteCallback();
+void nightlyCallback();
+
+void setup() {
+	Serial.begin(9600);
+
+	// Check next time of some rules after START_TIME
+	Serial.println(F("check rules"));
+	checkRule("0 2 * * *", START_TIME, 1792375200UL);             // Mon 19 Oct 02:00
+	checkRule("0-59/15 8-17 * * 1-5", START_TIME, 1792396800UL);  // Mon 19 Oct 08:00
+	checkRule("30 12 1,15 * 0", START_TIME, 1792326600UL);        // Sun 18 Oct 12:30 (day of week)
+	checkRule("0 0 13 * 5", START_TIME, 1792713600UL);            // Fri 23 Oct 00:00 (day of week)
+	checkRule("0 0 29 2 *", START_TIME, 1835395200UL);            // Tue 29 Feb 2028 (leap year)
+	checkRule("59 23 31 12 *", START_TIME, 1798761540UL);         // Thu 31 Dec 23:59
+	checkRule("0 0 31 2 *", START_TIME, 0);                       // never
+	checkRule("0 24 * * *", START_TIME, 0);                       // not valid
+
+	Serial.println(F("setup timer"));
+	timer.setup();
+	wallClock.set(START_TIME);
+
+	// Execute minuteCallback at the beginning of each minute
+	everyMinute.parse("* * * * *");
+	minuteTicket.setFunctionCallback<&minuteCallback>();
+	timer.schedCalendar(minuteTicket, everyMinute, wallClock);
+
+	// Execute nightlyCallback each day at 02:00
+	nightly.parse("0 2 * * *");
+	nightlyTicket.setFunctionCallback<&nightlyCallback>();
+	timer.schedCalendar(nightlyTicket, nightly, wallClock);
+
+	Serial.print(F("next nightly="));
+	printTime(nightlyTicket.getNextTime());
+	Serial.println();
+
+	Serial.println(F("start timer"));
+	timer.start();
+}
+
+void loop() {
+	timer.process();
+}
+
+void checkRule(const char *expr, WallClock::epoch_t after, WallClock::epoch_t expected) {
+	CalendarRule rule;
+	WallClock::epoch_t next = 0;
+	if (!rule.parse(expr) || !rule.next(after, next)) {
+		next = 0;
+	}
+
+	Serial.print(expr);
+	Serial.print(F(" -> "));
+	printTime(next);
+	Serial.println((next == expected) ? F(" OK") : F(" FAIL"));
+}
+
+void printTime(WallClock::epoch_t time) {
+	if (time == 0) {
+		Serial.print(F("none"));
+	} else {
+		Serial.print(time);
+	}
+}
+
+void minuteCallback() {
+	Serial.print(F("[minuteCallback]["));
+	printTime(wallClock.now());
+	Serial.println(']');
+}
+
+void nightlyCallback() {
+	Serial.println(F("[nightlyCallback]"));
+}
@@ -0,0 +1,88 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @section LICENSE                                                         ///
+///                                                                          ///
+///        Distributed under the Boost Software License, Version 1.0.        ///
+///             (See accompanying file LICENSE_1_0.txt or copy at            ///
+///                  http://www.boost.org/LICENSE_1_0.txt)                   ///
+///                                                                          ///
+/// @file                                                                    ///
+/// @author  Alejandro Morell Garcia <alejandro.morell@gmail.com>            ///
+/// @version 1.0                                                             ///
+////////////////////////////////////////////////////////////////////////////////
+
+#include <TimerLib.h>
+#include <UtilLib.h>
+#include <SRUtilLib.h>
+
+#include <util/SoftwareTimer.h>
+#include <util/ChildTimer.h>
+using util::SoftwareTimer;
+using util::ChildTimer;
+using util::TimerTicket;
+
+// Both child timers share the software timer as tick source
+SoftwareTimer timer;
+ChildTimer sensors(timer);
+ChildTimer network(timer);
+
+TimerTicket sensorTicket, networkTicket, toggleTicket;
+
+void showMillis(const __FlashStringHelper *);
+void readSensors();
+void pollNetwork();
+void toggleSensors();
+
+void setup() {
+	Serial.begin(9600);
+
+	Serial.println(F("setup timer"));
+	timer.setup();
+
+	// Read sensors each second
+	sensorTicket.setFunctionCallback<&readSensors>();
+	sensors.schedRepeat(sensorTicket, 1, TimerTicket::SECONDS);
+
+	// Poll network each 3 seconds
+	networkTicket.setFunctionCallback<&pollNetwork>();
+	network.schedRepeat(networkTicket, 3, TimerTicket::SECONDS);
+
+	// Stop and start sensors group each 5 seconds
+	toggleTicket.setFunctionCallback<&toggleSensors>();
+	timer.schedRepeat(toggleTicket, 5, TimerTicket::SECONDS, 5, TimerTicket::SECONDS);
+
+	Serial.println(F("start timer"));
+	sensors.start();
+	network.start();
+	timer.start();
+}
+
+void loop() {
+	timer.process();
+}
+
+void showMillis(const __FlashStringHelper *name) {
+	unsigned long m = millis();
+	Serial.print('[');
+	Serial.print(name);
+	Serial.print(F("]["));
+	Serial.print(m);
+	Serial.println(F("ms]"));
+}
+
+void readSensors() {
+	showMillis(F("readSensors"));
+}
+
+void pollNetwork() {
+	showMillis(F("pollNetwork"));
+}
+
+void toggleSensors() {
+	if (sensors.isRunning()) {
+		showMillis(F("sensors stop"));
+		sensors.stop();
+	} else {
+		showMillis(F("sensors start"));
+		sensors.start();
+	}
+}
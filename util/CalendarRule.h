@@ -0,0 +1,111 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @section LICENSE                                                         ///
+///                                                                          ///
+///        Distributed under the Boost Software License, Version 1.0.        ///
+///             (See accompanying file LICENSE_1_0.txt or copy at            ///
+///                  http://www.boost.org/LICENSE_1_0.txt)                   ///
+///                                                                          ///
+/// @file                                                                    ///
+/// @author  Alejandro Morell Garcia (http://github.com/amorellgarcia)       ///
+/// @version 1.0                                                             ///
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef UTIL_CALENDARRULE_H_
+#define UTIL_CALENDARRULE_H_
+
+#include "WallClock.h"
+#include <stdint.h>
+
+namespace util {
+
+/**
+ * Calendar rule with minute resolution, similar to a cron expression.
+ * Each field is stored as a bitmask, so next matching time is found by
+ * looking for the next enabled bit of each field instead of checking every
+ * minute.
+ *
+ * Rule can be built from bitmasks (so it can be a constant) or parsed from
+ * a cron expression at setup time:
+ * @code
+ * CalendarRule nightly;
+ * nightly.parse("0 2 * * *");           // every day at 02:00
+ * CalendarRule office;
+ * office.parse("*&#47;15 8-17 * * 1-5");  // weekdays, every 15 mins 08:00-17:45
+ * @endcode
+ *
+ * As in cron, if both day of month and day of week are restricted, a day
+ * matches when any of them matches.
+ */
+class CalendarRule {
+public:
+	static const uint64_t ALL_MINUTES = 0xFFFFFFFFFFFFFFFULL; //!< bits 0..59
+	static const uint32_t ALL_HOURS = 0xFFFFFFUL;              //!< bits 0..23
+	static const uint32_t ALL_DAYS_OF_MONTH = 0xFFFFFFFEUL;    //!< bits 1..31
+	static const uint16_t ALL_MONTHS = 0x1FFE;                 //!< bits 1..12
+	static const uint8_t ALL_DAYS_OF_WEEK = 0x7F;              //!< bits 0..6, Sunday is 0
+
+public:
+	/**
+	 * Default constructor. Rule matches every minute.
+	 */
+	CalendarRule();
+
+	/**
+	 * Build a rule from bitmasks. Bit @a n of each mask enables value @a n.
+	 *
+	 * @param minutes minutes mask (0..59).
+	 * @param hours hours mask (0..23).
+	 * @param daysOfMonth days of month mask (1..31).
+	 * @param months months mask (1..12).
+	 * @param daysOfWeek days of week mask (0..6, Sunday is 0).
+	 */
+	CalendarRule(uint64_t minutes, uint32_t hours, uint32_t daysOfMonth,
+			uint16_t months, uint8_t daysOfWeek);
+
+	/**
+	 * Parse a cron expression with the following fields separated by spaces:
+	 * minute (0-59), hour (0-23), day of month (1-31), month (1-12) and day
+	 * of week (0-7, both 0 and 7 are Sunday).
+	 * Each field is a list of items separated by commas. An item is @a *,
+	 * a value or a range @a a-b, optionally followed by a step @a /n.
+	 *
+	 * If expression is not valid, rule is not modified.
+	 *
+	 * @param expr cron expression.
+	 * @return true if parsed, false otherwise.
+	 */
+	bool parse(const char *expr);
+
+	/**
+	 * Get first time matching this rule after a given time.
+	 *
+	 * @param after time after which to search.
+	 * @param result matching time, only set when found.
+	 * @return true if found, false if rule never matches (e.g. a field has an
+	 * 	empty mask).
+	 */
+	bool next(WallClock::epoch_t after, WallClock::epoch_t &result) const;
+
+private:
+	enum flags_t {
+		FLAG_ANY_DAY_OF_MONTH = 1 << 0,
+		FLAG_ANY_DAY_OF_WEEK = 1 << 1,
+	};
+
+	void setMasks(uint64_t minutes, uint32_t hours, uint32_t daysOfMonth,
+			uint16_t months, uint8_t daysOfWeek);
+	bool isEmpty() const;
+	uint32_t getDaysMask(uint16_t year, uint8_t month) const;
+
+private:
+	uint64_t m_minutes;
+	uint32_t m_hours;
+	uint32_t m_daysOfMonth;
+	uint16_t m_months;
+	uint8_t m_daysOfWeek;
+	uint8_t m_flags;
+};
+
+} // namespace util
+
+#endif // UTIL_CALENDARRULE_H_
@@ -0,0 +1,72 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @section LICENSE                                                         ///
+///                                                                          ///
+///        Distributed under the Boost Software License, Version 1.0.        ///
+///             (See accompanying file LICENSE_1_0.txt or copy at            ///
+///                  http://www.boost.org/LICENSE_1_0.txt)                   ///
+///                                                                          ///
+/// @file                                                                    ///
+/// @author  Alejandro Morell Garcia (http://github.com/amorellgarcia)       ///
+/// @version 1.0                                                             ///
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef UTIL_CALENDARTICKET_H_
+#define UTIL_CALENDARTICKET_H_
+
+#include "Timer.h"
+#include "CalendarRule.h"
+#include "WallClock.h"
+
+namespace util {
+
+/**
+ * Ticket executed at times given by a @a CalendarRule.
+ * It is scheduled with @a Timer::schedCalendar. Each execution time is
+ * computed from the previous one and the wall-clock, so it does not drift
+ * as long as the @a WallClock is kept in time.
+ *
+ * Usage:
+ * @code
+ * WallClock clock;
+ * CalendarRule nightly;
+ * CalendarTicket backup;
+ * // ...
+ * clock.set(rtcSeconds);
+ * nightly.parse("0 2 * * *");
+ * backup.setFunctionCallback<&doBackup>();
+ * timer.schedCalendar(backup, nightly, clock);
+ * @endcode
+ */
+class CalendarTicket : public TimerTicket {
+public:
+	/**
+	 * Default constructor.
+	 */
+	CalendarTicket();
+
+	/**
+	 * Get time of next execution.
+	 *
+	 * @return seconds since 1970-01-01 00:00:00.
+	 */
+	const WallClock::epoch_t &getNextTime() const;
+
+private:
+	bool isDue(const unsigned long &currentMs) const;
+	bool advance(const unsigned long &currentMs);
+	unsigned long getDelay(const unsigned long &currentMs) const;
+
+	friend class Timer;
+private:
+	const CalendarRule *m_rule;
+	const WallClock *m_clock;
+	WallClock::epoch_t m_nextTime;
+};
+
+inline const WallClock::epoch_t &CalendarTicket::getNextTime() const {
+	return m_nextTime;
+}
+
+} // namespace util
+
+#endif // UTIL_CALENDARTICKET_H_
@@ -0,0 +1,64 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @section LICENSE                                                         ///
+///                                                                          ///
+///        Distributed under the Boost Software License, Version 1.0.        ///
+///             (See accompanying file LICENSE_1_0.txt or copy at            ///
+///                  http://www.boost.org/LICENSE_1_0.txt)                   ///
+///                                                                          ///
+/// @file                                                                    ///
+/// @author  Alejandro Morell Garcia (http://github.com/amorellgarcia)       ///
+/// @version 1.0                                                             ///
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef UTIL_CHILDTIMER_H_
+#define UTIL_CHILDTIMER_H_
+
+#include "Timer.h"
+
+namespace util {
+
+/**
+ * Timer implementation that runs on top of another (parent) @a Timer.
+ * Each child uses a single ticket in its parent to wake up at the next
+ * scheduled tick, so any number of child timers can share one low-level
+ * timer source. Child tickets are started and stopped as a group with
+ * @a start and @a stop.
+ *
+ * Stopping a child does not touch its parent: a pending wake up is kept and
+ * ignored when it arrives.
+ *
+ * Usage:
+ * @code
+ * SoftwareTimer timer;
+ * ChildTimer network(timer), sensors(timer);
+ * // ...
+ * network.schedRepeat(pollTicket, 1, TimerTicket::SECONDS);
+ * network.start();
+ * timer.start();
+ * @endcode
+ */
+class ChildTimer : public Timer {
+public:
+	/**
+	 * Constructor.
+	 *
+	 * @param parent timer used as tick source. It must outlive this timer.
+	 */
+	explicit ChildTimer(Timer &parent);
+
+private:
+	void lowLevelSetup() {}
+	void lock();
+	void unlock();
+	void setNextTickTimer(const unsigned long &tickDelay);
+
+	void parentTick();
+
+private:
+	Timer &m_parent;
+	TimerTicket m_ticket;
+};
+
+} // namespace util
+
+#endif // UTIL_CHILDTIMER_H_
@@ -18,6 +18,10 @@
 
 namespace util {
 
+class CalendarTicket;
+class CalendarRule;
+class WallClock;
+
 
 /**
  * Used by @a Timer class to store a scheduled call-back execution.
@@ -39,7 +43,16 @@ public:
 		DAYS,   //!< DAYS time is in days. Arduino only supports until 51 days
 	};
 
+	enum {
+		NO_ID = 0xFF, //!< NO_ID ticket is not saved by @a Timer::saveSchedule
+	};
+
 public:
+	/**
+	 * Default constructor.
+	 */
+	TimerTicket();
+
 	/**
 	 * Check if this ticket is scheduled for execution in a timer.
 	 *
@@ -54,6 +67,22 @@ public:
 	 */
 	void printTo(Print &p) const;
 
+	/**
+	 * Set ticket ID used by @a Timer::saveSchedule and
+	 * @a Timer::restoreSchedule to identify this ticket across restarts.
+	 *
+	 * @param id index of this ticket in the table given to
+	 * 	@a Timer::restoreSchedule, or @a NO_ID.
+	 */
+	void setId(uint8_t id);
+
+	/**
+	 * Get ticket ID.
+	 *
+	 * @return ticket ID, @a NO_ID if not set.
+	 */
+	uint8_t getId() const;
+
 	/**
 	 * Set a function as call-back.
 	 * Function must have the following declaration:
@@ -121,9 +150,11 @@ private:
 	typedef srutil::delegate<void ()> delegate_t;
 	enum flags_t {
 		OFFSET_UNITS = 0,
-		MASK_UNITS = 0x3 << OFFSET_UNITS,
-		OFFSET_FIRST_FLAG = 2,
+		MASK_UNITS = 0x7 << OFFSET_UNITS,
+		OFFSET_FIRST_FLAG = 3,
 		FLAG_TICKET_SCHEDULED = 1 << OFFSET_FIRST_FLAG,
+		FLAG_CALENDAR = 1 << (OFFSET_FIRST_FLAG + 1),
+		FLAG_SPREAD = 1 << (OFFSET_FIRST_FLAG + 2),
 	};
 
 	bool isFlagEnabled(flags_t flag) const;
@@ -132,6 +163,7 @@ private:
 	units_t getPeriodUnits() const;
 
 	void setScheduled(bool value);
+	static unsigned long toMillis(uint16_t time, units_t units);
 	void setDelayOffset(uint16_t delay, units_t units);
 	void setPeriodUnits(units_t units);
 
@@ -142,8 +174,17 @@ private:
 	delegate_t m_delegate;
 	uint16_t m_period;
 	flags_t m_flags;
+	uint8_t m_id;
 };
 
+inline void TimerTicket::setId(uint8_t id) {
+	m_id = id;
+}
+
+inline uint8_t TimerTicket::getId() const {
+	return m_id;
+}
+
 template <void func()>
 inline void TimerTicket::setFunctionCallback() {
 	m_delegate = delegate_t::from_function<func>();
@@ -167,6 +208,30 @@ class Timer {
 public:
 	typedef uint16_t time_t;
 
+	/**
+	 * Schedule of a ticket used by @a schedBulk.
+	 * Fields have the same meaning as @a schedRepeat parameters. A @a period
+	 * of 0 means single execution.
+	 */
+	struct entry_t {
+		TimerTicket *ticket;
+		time_t delay;
+		TimerTicket::units_t delayUnits;
+		time_t period;
+		TimerTicket::units_t periodUnits;
+	};
+
+	/**
+	 * Load statistics of a timer.
+	 *
+	 * @see getStats
+	 * @see getScheduleStats
+	 */
+	struct stats_t {
+		uint8_t peakDue;       //!< peakDue max tickets executed in a tick without load spreading
+		uint8_t peakDueSpread; //!< peakDueSpread max tickets executed in a tick with load spreading
+	};
+
 public:
 	/**
 	 * Default constructor.
@@ -179,8 +244,7 @@ public:
 	 * elapsed time counts since this method was called. If not running, elapsed
 	 * time counts since timer is started.
 	 *
-	 * If @a ticket is already scheduled, this method does nothing and returns
-	 * false.
+	 * If @a ticket is already scheduled, it is rescheduled.
 	 *
 	 * @param ticket ticket to use in execution.
 	 * @param delay delay time
@@ -196,8 +260,7 @@ public:
 	 * For first execution, this schedule works as @a schedOneTime. After that
 	 * @a period is used to calculate delays between each execution.
 	 *
-	 * If @a ticket is already scheduled, this method does nothing and returns
-	 * false.
+	 * If @a ticket is already scheduled, it is rescheduled.
 	 *
 	 * @param ticket ticket to use in execution.
 	 * @param delay delay time
@@ -217,8 +280,10 @@ public:
 	 * of 0ms. After that @a period is used to calculate delays between each
 	 * execution.
 	 *
-	 * If @a ticket is already scheduled, this method does nothing and returns
-	 * false.
+	 * If @a ticket is already scheduled, it is rescheduled.
+	 *
+	 * If load spreading is enabled, first execution is delayed so executions
+	 * of tickets with the same period are spread along the period.
 	 *
 	 * @param ticket ticket to use in execution.
 	 * @param period delay time between executions
@@ -226,10 +291,118 @@ public:
 	 * @return true if scheduled, false otherwise.
 	 *
 	 * @see schedOneTime
+	 * @see setLoadSpreading
 	 * @see TimerTicket::units_t
 	 */
 	bool schedRepeat(TimerTicket &ticket, time_t period, TimerTicket::units_t periodUnits);
 
+	/**
+	 * Schedule a ticket for execution at times given by a calendar rule.
+	 * First execution is the first time matching @a rule after current time
+	 * of @a clock. After each execution, next time is computed from previous
+	 * one.
+	 *
+	 * If @a ticket is already scheduled, it is rescheduled.
+	 *
+	 * @param ticket ticket to use in execution.
+	 * @param rule calendar rule. It must outlive the schedule.
+	 * @param clock wall-clock used to evaluate @a rule. It must be set and
+	 * 	outlive the schedule.
+	 * @return true if scheduled, false if clock is not set or rule never
+	 * 	matches.
+	 *
+	 * @see CalendarRule
+	 */
+	bool schedCalendar(CalendarTicket &ticket, const CalendarRule &rule, const WallClock &clock);
+
+	/**
+	 * Schedule several tickets at once.
+	 * It works as calling @a schedRepeat for each entry, but all delays count
+	 * since the same time and tickets are sorted once and merged with
+	 * scheduled ones in a single pass. Use it when a lot of tickets are
+	 * scheduled together, e.g. at startup.
+	 *
+	 * Entries with a NULL ticket or a ticket that appears in a previous entry
+	 * are ignored.
+	 *
+	 * Usage:
+	 * @code
+	 * Timer::entry_t entries[] = {
+	 *     { &ledTicket, 0, TimerTicket::MILLIS, 500, TimerTicket::MILLIS },
+	 *     { &logTicket, 5, TimerTicket::SECONDS, 1, TimerTicket::MINUTES },
+	 * };
+	 * timer.schedBulk(entries, 2);
+	 * @endcode
+	 *
+	 * @param entries tickets to schedule.
+	 * @param count number of entries.
+	 * @return number of scheduled tickets.
+	 *
+	 * @see schedRepeat
+	 */
+	uint8_t schedBulk(const entry_t entries[], uint8_t count);
+
+	/**
+	 * Remove a ticket from schedule, so it is not executed anymore.
+	 * If it was placed by load spreading, tickets with its period are
+	 * placed again to fill its gap.
+	 *
+	 * @param ticket ticket to remove.
+	 * @return true if removed, false if it was not scheduled.
+	 */
+	bool unsched(TimerTicket &ticket);
+
+	/**
+	 * Save scheduled tickets to @a data, so they can be restored after a
+	 * reset with @a restoreSchedule keeping their phase.
+	 * For each ticket it saves its ID, remaining delay and period. It uses
+	 * 3 bytes plus 8 bytes per ticket.
+	 *
+	 * Only tickets with an ID are saved. Calendar tickets are not saved
+	 * since they are scheduled again from their rule.
+	 *
+	 * Timer is locked while saving, so @a data is a RAM buffer that can be
+	 * copied later to EEPROM, RTC memory or a file.
+	 *
+	 * @param data buffer where to save.
+	 * @param size size of @a data in bytes.
+	 * @return number of bytes saved, 0 if @a data is too small.
+	 *
+	 * @see getScheduleSize
+	 * @see TimerTicket::setId
+	 */
+	size_t saveSchedule(uint8_t *data, size_t size);
+
+	/**
+	 * Get number of bytes needed by @a saveSchedule for current tickets.
+	 *
+	 * @return size in bytes.
+	 */
+	size_t getScheduleSize();
+
+	/**
+	 * Restore tickets saved with @a saveSchedule.
+	 * Each saved ticket is scheduled again with its remaining delay and
+	 * period. Saved IDs are used as index in @a tickets table. Saved tickets
+	 * not found in @a tickets are ignored. Only restored tickets are
+	 * rescheduled; other tickets in @a tickets are not modified.
+	 *
+	 * Remaining delays count since this method is called, minus @a elapsed.
+	 * Tickets whose delay expired during @a elapsed are executed at next
+	 * tick.
+	 *
+	 * @param data saved data.
+	 * @param size size of @a data in bytes.
+	 * @param tickets table of tickets indexed by ID.
+	 * @param count number of tickets in @a tickets.
+	 * @param elapsed time (in milliseconds) elapsed since data was saved,
+	 * 	if known (for example, time spent in deep-sleep).
+	 * @return true if restored, false if @a data is not valid.
+	 */
+	bool restoreSchedule(const uint8_t *data, size_t size,
+			TimerTicket *const tickets[], uint8_t count,
+			const unsigned long &elapsed = 0);
+
 	/**
 	 * Setups timer.
 	 */
@@ -252,6 +425,63 @@ public:
 	 */
 	bool isRunning() const;
 
+	/**
+	 * Enable or disable load spreading.
+	 * When enabled, repeated tickets scheduled without delay (with
+	 * @a schedRepeat or @a schedBulk) are not executed at once, but spread
+	 * along their period with other tickets placed this way with the same
+	 * period, so they are not executed in the same tick.
+	 *
+	 * Each time one of these tickets is added, rescheduled or removed, all
+	 * tickets of its period group are evenly placed again along the period,
+	 * keeping the execution time of the earliest one. This takes a single
+	 * pass over scheduled tickets. Tickets scheduled with a delay, calendar
+	 * tickets and tickets restored with @a restoreSchedule keep their phase
+	 * and are never moved.
+	 *
+	 * It is disabled by default.
+	 *
+	 * @param enabled true to enable, false to disable.
+	 */
+	void setLoadSpreading(bool enabled);
+
+	/**
+	 * Check if load spreading is enabled.
+	 *
+	 * @return true if enabled, false otherwise.
+	 */
+	bool isLoadSpreading() const;
+
+	/**
+	 * Get load statistics. They are kept separately for ticks with load
+	 * spreading enabled and disabled. Each value is only updated by ticks
+	 * executed while load spreading is in the matching mode. Use
+	 * @a getScheduleStats to compare both modes for current schedule.
+	 *
+	 * @return load statistics.
+	 */
+	const stats_t &getStats() const;
+
+	/**
+	 * Compute load statistics of scheduled tickets, for their next
+	 * executions. @a peakDueSpread is the max number of tickets with the same
+	 * execution time. @a peakDue is the same number as if tickets placed by
+	 * load spreading were executed with the first one of their period, as
+	 * they would be when scheduled together without it. So both numbers can
+	 * be compared without running the timer.
+	 *
+	 * Its cost is quadratic with the number of scheduled tickets, so it is
+	 * intended for debugging.
+	 *
+	 * @return load statistics of scheduled tickets.
+	 */
+	stats_t getScheduleStats();
+
+	/**
+	 * Reset load statistics.
+	 */
+	void resetStats();
+
 	/**
 	 * Prints a list with all scheduled tickets.
 	 * This method purpose is only debugging.
@@ -299,22 +529,58 @@ protected:
 	const unsigned long &getLastTick() const;
 
 private:
+	/**
+	 * Schedule a ticket for single execution after @a delay milliseconds.
+	 * Unlike @a schedOneTime, delay is not limited to @a time_t range and
+	 * low-level timer is updated if ticket becomes the next one.
+	 */
+	void schedMillis(TimerTicket &ticket, const unsigned long &delay);
+
+	/**
+	 * Update low-level timer if @a ticket has become the next one.
+	 */
+	void updateNextTick(const TimerTicket &ticket);
+
 	TimerTicket *findPreviousTicket(TimerTicket &ticket);
 	void removeNextTicket(TimerTicket &ticket);
 	void removeTicket(TimerTicket &ticket);
 	void addTicket(TimerTicket &ticket);
+	void mergeTickets(TimerTicket *tickets);
+	static TimerTicket *sortTickets(TimerTicket *tickets);
 	void updateSchedule(const unsigned long &currenMs);
+	void unscheduleTicket(TimerTicket &ticket);
+	void spreadTickets(TimerTicket *tickets, uint8_t count, const unsigned long &currentDelay) const;
+	void rebalanceTickets(const unsigned long &period, const unsigned long &currentDelay);
+	uint8_t countUnspreadTickets(const TimerTicket &ticket) const;
+	static bool isSpreadTicket(const TimerTicket &ticket, const unsigned long &period);
+	static void setRelativeDelays(TimerTicket *tickets);
 
 private:
 	unsigned long m_lastTick;
 	TimerTicket *m_firstTicket;
+	stats_t m_stats;
 	bool m_running;
+	bool m_loadSpreading;
+
+	friend class ChildTimer;
 };
 
 inline bool Timer::isRunning() const {
 	return m_running;
 }
 
+inline void Timer::setLoadSpreading(bool enabled) {
+	m_loadSpreading = enabled;
+}
+
+inline bool Timer::isLoadSpreading() const {
+	return m_loadSpreading;
+}
+
+inline const Timer::stats_t &Timer::getStats() const {
+	return m_stats;
+}
+
 inline const unsigned long &Timer::getLastTick() const {
 	return m_lastTick;
 }
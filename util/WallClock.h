@@ -0,0 +1,92 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @section LICENSE                                                         ///
+///                                                                          ///
+///        Distributed under the Boost Software License, Version 1.0.        ///
+///             (See accompanying file LICENSE_1_0.txt or copy at            ///
+///                  http://www.boost.org/LICENSE_1_0.txt)                   ///
+///                                                                          ///
+/// @file                                                                    ///
+/// @author  Alejandro Morell Garcia (http://github.com/amorellgarcia)       ///
+/// @version 1.0                                                             ///
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef UTIL_WALLCLOCK_H_
+#define UTIL_WALLCLOCK_H_
+
+#include <stdint.h>
+
+namespace util {
+
+/**
+ * Wall-clock time source used by @a CalendarTicket.
+ * Time is set from an external reference (RTC, NTP, ...) and then advanced
+ * using @a millis(). Since @a millis() overflows every 49 days, clock must be
+ * set again before that time elapses. Setting it periodically also corrects
+ * oscillator drift.
+ *
+ * Time is expressed as seconds since 1970-01-01 00:00:00. Calendar rules are
+ * evaluated against this value, so it should be local time if rules are
+ * written in local time.
+ */
+class WallClock {
+public:
+	typedef uint32_t epoch_t;
+
+public:
+	/**
+	 * Default constructor. Clock is not set.
+	 */
+	WallClock();
+
+	/**
+	 * Set current time.
+	 *
+	 * @param seconds seconds since 1970-01-01 00:00:00.
+	 */
+	void set(epoch_t seconds);
+
+	/**
+	 * Check if clock has been set.
+	 *
+	 * @return true if set, false otherwise.
+	 */
+	bool isSet() const;
+
+	/**
+	 * Get current time.
+	 *
+	 * @return seconds since 1970-01-01 00:00:00.
+	 */
+	epoch_t now() const;
+
+	/**
+	 * Get time for a given @a millis() reading.
+	 *
+	 * @param ms value returned by @a millis().
+	 * @return seconds since 1970-01-01 00:00:00.
+	 */
+	epoch_t at(const unsigned long &ms) const;
+
+	/**
+	 * Get milliseconds that must elapse since a @a millis() reading until
+	 * a given time.
+	 *
+	 * @param time seconds since 1970-01-01 00:00:00.
+	 * @param ms value returned by @a millis().
+	 * @return milliseconds until @a time, 0 if already reached.
+	 */
+	unsigned long millisUntil(epoch_t time, const unsigned long &ms) const;
+
+private:
+	epoch_t m_epoch;
+	unsigned long m_setMs;
+	bool m_set;
+};
+
+inline bool WallClock::isSet() const {
+	return m_set;
+}
+
+} // namespace util
+
+#endif // UTIL_WALLCLOCK_H_
@@ -0,0 +1,318 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @section LICENSE                                                         ///
+///                                                                          ///
+///        Distributed under the Boost Software License, Version 1.0.        ///
+///             (See accompanying file LICENSE_1_0.txt or copy at            ///
+///                  http://www.boost.org/LICENSE_1_0.txt)                   ///
+///                                                                          ///
+/// @file                                                                    ///
+/// @author  Alejandro Morell Garcia                                         ///
+/// @version 1.0                                                             ///
+////////////////////////////////////////////////////////////////////////////////
+#include "util/CalendarRule.h"
+#include <stddef.h>
+
+#define SECONDS_PER_MINUTE	60UL
+#define SECONDS_PER_HOUR	3600UL
+#define SECONDS_PER_DAY		86400UL
+// Enough to find a 29th of February across a non-leap century year.
+#define MAX_SEARCH_MONTHS	(12 * 9)
+// Last year representable by WallClock::epoch_t.
+#define MAX_YEAR			2105
+
+namespace util {
+
+namespace calendar_detail {
+
+/**
+ * Get position of first enabled bit of @a mask in range [from, last].
+ * Returns -1 if there is not any.
+ */
+template <typename T>
+static int8_t nextBit(T mask, uint8_t from, uint8_t last) {
+	for (uint8_t bit = from; bit <= last; bit++) {
+		if ((mask >> bit) & 1) {
+			return bit;
+		}
+	}
+	return -1;
+}
+
+static bool isLeapYear(uint16_t year) {
+	return (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+}
+
+static uint8_t daysInMonth(uint16_t year, uint8_t month) {
+	switch (month) {
+	case 2:
+		return isLeapYear(year) ? 29 : 28;
+	case 4: case 6: case 9: case 11:
+		return 30;
+	default:
+		return 31;
+	}
+}
+
+// Conversion between civil dates and days since 1970-01-01.
+// See http://howardhinnant.github.io/date_algorithms.html
+static uint32_t daysFromCivil(uint16_t year, uint8_t month, uint8_t day) {
+	uint32_t y = year - (month <= 2);
+	uint32_t era = y / 400;
+	uint32_t yoe = y - era * 400;
+	uint32_t doy = (153UL * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+	uint32_t doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+	return era * 146097UL + doe - 719468UL;
+}
+
+static void civilFromDays(uint32_t days, uint16_t &year, uint8_t &month, uint8_t &day) {
+	days += 719468UL;
+	uint32_t era = days / 146097UL;
+	uint32_t doe = days - era * 146097UL;
+	uint32_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+	uint32_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+	uint32_t mp = (5 * doy + 2) / 153;
+	day = doy - (153 * mp + 2) / 5 + 1;
+	month = mp < 10 ? mp + 3 : mp - 9;
+	year = yoe + era * 400 + (month <= 2);
+}
+
+static bool parseNumber(const char *&p, uint8_t &value) {
+	if (*p < '0' || *p > '9') {
+		return false;
+	}
+	uint16_t n = 0;
+	while (*p >= '0' && *p <= '9') {
+		n = n * 10 + (*p - '0');
+		if (n > 255) {
+			return false;
+		}
+		p++;
+	}
+	value = n;
+	return true;
+}
+
+/**
+ * Parse a field of a cron expression into @a mask.
+ * @a any is set if field is a single @a *.
+ */
+static bool parseField(const char *&p, uint8_t min, uint8_t max, uint64_t &mask, bool &any) {
+	mask = 0;
+	any = (p[0] == '*' && (p[1] == ' ' || p[1] == '\0'));
+	for (;;) {
+		uint8_t first = min, last = max, step = 1;
+		if (*p == '*') {
+			p++;
+		} else {
+			if (!parseNumber(p, first)) {
+				return false;
+			}
+			last = first;
+			if (*p == '-') {
+				p++;
+				if (!parseNumber(p, last)) {
+					return false;
+				}
+			}
+		}
+		if (*p == '/') {
+			p++;
+			if (!parseNumber(p, step) || step == 0) {
+				return false;
+			}
+		}
+		if (first < min || last > max || first > last) {
+			return false;
+		}
+		for (uint16_t value = first; value <= last; value += step) {
+			mask |= 1ULL << value;
+		}
+
+		if (*p != ',') {
+			break;
+		}
+		p++;
+	}
+
+	if (*p == ' ') {
+		while (*p == ' ') {
+			p++;
+		}
+	} else if (*p != '\0') {
+		return false;
+	}
+	return true;
+}
+
+} // namespace calendar_detail
+
+using namespace calendar_detail;
+
+CalendarRule::CalendarRule() {
+	setMasks(ALL_MINUTES, ALL_HOURS, ALL_DAYS_OF_MONTH, ALL_MONTHS, ALL_DAYS_OF_WEEK);
+}
+
+CalendarRule::CalendarRule(uint64_t minutes, uint32_t hours,
+		uint32_t daysOfMonth, uint16_t months, uint8_t daysOfWeek)
+{
+	setMasks(minutes, hours, daysOfMonth, months, daysOfWeek);
+}
+
+void CalendarRule::setMasks(uint64_t minutes, uint32_t hours,
+		uint32_t daysOfMonth, uint16_t months, uint8_t daysOfWeek)
+{
+	m_minutes = minutes & ALL_MINUTES;
+	m_hours = hours & ALL_HOURS;
+	m_daysOfMonth = daysOfMonth & ALL_DAYS_OF_MONTH;
+	m_months = months & ALL_MONTHS;
+	m_daysOfWeek = daysOfWeek & ALL_DAYS_OF_WEEK;
+	m_flags = 0;
+	if (m_daysOfMonth == ALL_DAYS_OF_MONTH) {
+		m_flags |= FLAG_ANY_DAY_OF_MONTH;
+	}
+	if (m_daysOfWeek == ALL_DAYS_OF_WEEK) {
+		m_flags |= FLAG_ANY_DAY_OF_WEEK;
+	}
+}
+
+bool CalendarRule::parse(const char *expr) {
+	uint64_t minutes, hours, daysOfMonth, months, daysOfWeek;
+	bool anyDayOfMonth, anyDayOfWeek, any;
+
+	const char *p = expr;
+	while (*p == ' ') {
+		p++;
+	}
+	if (!parseField(p, 0, 59, minutes, any)
+			|| !parseField(p, 0, 23, hours, any)
+			|| !parseField(p, 1, 31, daysOfMonth, anyDayOfMonth)
+			|| !parseField(p, 1, 12, months, any)
+			|| !parseField(p, 0, 7, daysOfWeek, anyDayOfWeek)
+			|| *p != '\0')
+	{
+		return false;
+	}
+
+	// Sunday can be written as 0 or 7
+	if (daysOfWeek & (1 << 7)) {
+		daysOfWeek |= 1;
+	}
+	setMasks(minutes, hours, daysOfMonth, months, daysOfWeek);
+
+	// A restricted field that covers all values must not be taken as '*'
+	m_flags = 0;
+	if (anyDayOfMonth) {
+		m_flags |= FLAG_ANY_DAY_OF_MONTH;
+	}
+	if (anyDayOfWeek) {
+		m_flags |= FLAG_ANY_DAY_OF_WEEK;
+	}
+	return true;
+}
+
+bool CalendarRule::isEmpty() const {
+	if (m_minutes == 0 || m_hours == 0 || m_months == 0) {
+		return true;
+	}
+	if (m_flags & (FLAG_ANY_DAY_OF_MONTH | FLAG_ANY_DAY_OF_WEEK)) {
+		return m_daysOfMonth == 0 || m_daysOfWeek == 0;
+	}
+	return m_daysOfMonth == 0 && m_daysOfWeek == 0;
+}
+
+uint32_t CalendarRule::getDaysMask(uint16_t year, uint8_t month) const {
+	uint8_t length = daysInMonth(year, month);
+	uint8_t weekDay = (daysFromCivil(year, month, 1) + 4) % 7;
+
+	uint32_t daysOfWeek = 0;
+	for (uint8_t day = 1; day <= length; day++) {
+		if (m_daysOfWeek & (1 << weekDay)) {
+			daysOfWeek |= 1UL << day;
+		}
+		weekDay = (weekDay == 6) ? 0 : weekDay + 1;
+	}
+
+	uint32_t mask;
+	if (m_flags & (FLAG_ANY_DAY_OF_MONTH | FLAG_ANY_DAY_OF_WEEK)) {
+		mask = m_daysOfMonth & daysOfWeek;
+	} else {
+		mask = m_daysOfMonth | daysOfWeek;
+	}
+	return mask & (0xFFFFFFFFUL >> (31 - length));
+}
+
+bool CalendarRule::next(WallClock::epoch_t after, WallClock::epoch_t &result) const {
+	if (isEmpty()) {
+		return false;
+	}
+
+	uint32_t days = after / SECONDS_PER_DAY;
+	uint32_t seconds = after % SECONDS_PER_DAY + SECONDS_PER_MINUTE;
+	if (seconds >= SECONDS_PER_DAY) {
+		seconds -= SECONDS_PER_DAY;
+		days++;
+	}
+	uint8_t hour = seconds / SECONDS_PER_HOUR;
+	uint8_t minute = (seconds % SECONDS_PER_HOUR) / SECONDS_PER_MINUTE;
+
+	uint16_t year;
+	uint8_t month, day;
+	civilFromDays(days, year, month, day);
+
+	uint8_t searchedMonths = 0;
+	while (searchedMonths <= MAX_SEARCH_MONTHS && year <= MAX_YEAR) {
+		int8_t found = -1;
+		if (m_months & (1 << month)) {
+			found = nextBit(getDaysMask(year, month), day, 31);
+		}
+		if (found < 0) {
+			// Go to first day of next month
+			if (++month > 12) {
+				month = 1;
+				year++;
+			}
+			day = 1;
+			hour = 0;
+			minute = 0;
+			searchedMonths++;
+			continue;
+		}
+		if (found != day) {
+			day = found;
+			hour = 0;
+			minute = 0;
+		}
+
+		found = nextBit(m_hours, hour, 23);
+		if (found < 0) {
+			day++;
+			hour = 0;
+			minute = 0;
+			continue;
+		}
+		if (found != hour) {
+			hour = found;
+			minute = 0;
+		}
+
+		found = nextBit(m_minutes, minute, 59);
+		if (found < 0) {
+			hour++;
+			minute = 0;
+			continue;
+		}
+		minute = found;
+
+		uint32_t matchDays = daysFromCivil(year, month, day);
+		if (matchDays > (WallClock::epoch_t)~0UL / SECONDS_PER_DAY - 1) {
+			return false;
+		}
+		result = matchDays * SECONDS_PER_DAY + hour * SECONDS_PER_HOUR
+				+ minute * SECONDS_PER_MINUTE;
+		return true;
+	}
+
+	return false;
+}
+
+} // namespace util
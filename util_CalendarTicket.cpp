@@ -0,0 +1,48 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @section LICENSE                                                         ///
+///                                                                          ///
+///        Distributed under the Boost Software License, Version 1.0.        ///
+///             (See accompanying file LICENSE_1_0.txt or copy at            ///
+///                  http://www.boost.org/LICENSE_1_0.txt)                   ///
+///                                                                          ///
+/// @file                                                                    ///
+/// @author  Alejandro Morell Garcia                                         ///
+/// @version 1.0                                                             ///
+////////////////////////////////////////////////////////////////////////////////
+#include "util/CalendarTicket.h"
+#include <stddef.h>
+
+// Maximum delay between checks of the wall-clock. Limits the error when the
+// clock is set again while waiting.
+#define MAX_CALENDAR_DELAY	(60UL * 60UL * 1000UL)
+
+namespace util {
+
+CalendarTicket::CalendarTicket()
+	: m_rule(NULL)
+	, m_clock(NULL)
+	, m_nextTime(0)
+{
+}
+
+bool CalendarTicket::isDue(const unsigned long &currentMs) const {
+	return m_clock->millisUntil(m_nextTime, currentMs) == 0;
+}
+
+bool CalendarTicket::advance(const unsigned long &currentMs) {
+	WallClock::epoch_t from = m_clock->at(currentMs);
+	if (from < m_nextTime) {
+		from = m_nextTime;
+	}
+	return m_rule->next(from, m_nextTime);
+}
+
+unsigned long CalendarTicket::getDelay(const unsigned long &currentMs) const {
+	unsigned long delay = m_clock->millisUntil(m_nextTime, currentMs);
+	if (delay > MAX_CALENDAR_DELAY) {
+		delay = MAX_CALENDAR_DELAY;
+	}
+	return delay;
+}
+
+} // namespace util
@@ -0,0 +1,46 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @section LICENSE                                                         ///
+///                                                                          ///
+///        Distributed under the Boost Software License, Version 1.0.        ///
+///             (See accompanying file LICENSE_1_0.txt or copy at            ///
+///                  http://www.boost.org/LICENSE_1_0.txt)                   ///
+///                                                                          ///
+/// @file                                                                    ///
+/// @author  Alejandro Morell Garcia                                         ///
+/// @version 1.0                                                             ///
+////////////////////////////////////////////////////////////////////////////////
+#include "util/ChildTimer.h"
+#include <util/time.h>
+#include <Arduino.h>
+
+
+namespace util {
+
+ChildTimer::ChildTimer(Timer &parent)
+	: m_parent(parent)
+{
+	m_ticket.setMethodCallback<ChildTimer, &ChildTimer::parentTick>(this);
+}
+
+void ChildTimer::lock() {
+	m_parent.lock();
+}
+
+void ChildTimer::unlock() {
+	m_parent.unlock();
+}
+
+void ChildTimer::setNextTickTimer(const unsigned long &delay) {
+	// Delay counts since last tick of this timer, but parent counts it
+	// since now.
+	unsigned long elapsed = elapsedTime(getLastTick(), millis());
+	m_parent.schedMillis(m_ticket, (delay > elapsed) ? delay - elapsed : 0);
+}
+
+void ChildTimer::parentTick() {
+	if (isRunning()) {
+		doTick(m_parent.getLastTick());
+	}
+}
+
+} // namespace util
@@ -10,6 +10,7 @@
 /// @version 1.0                                                             ///
 ////////////////////////////////////////////////////////////////////////////////
 #include "util/Timer.h"
+#include "util/CalendarTicket.h"
 #include "util/time.h"
 #include "util/detail/pstrings.h"
 #include "util/bitfield.h"
@@ -34,6 +35,34 @@ namespace timer_detail {
 	PGMSPACE_STRING(UNKNOWN, "");
 	PGMSPACE_ARRAY(PgmSpaceString, UNIT_STRING_LIST,
 			MILLIS, SECONDS, MINUTES, HOURS, DAYS);
+
+	// Schedule saved by Timer::saveSchedule
+	const uint8_t SCHEDULE_MAGIC = 'T';
+	const uint8_t SCHEDULE_VERSION = 1;
+	const size_t SCHEDULE_HEADER_SIZE = 3;
+	const size_t SCHEDULE_RECORD_SIZE = 8;
+
+	static void write16(uint8_t *data, uint16_t value) {
+		data[0] = static_cast<uint8_t>(value);
+		data[1] = static_cast<uint8_t>(value >> 8);
+	}
+
+	static void write32(uint8_t *data, uint32_t value) {
+		write16(data, static_cast<uint16_t>(value));
+		write16(data + 2, static_cast<uint16_t>(value >> 16));
+	}
+
+	static uint16_t read16(const uint8_t *data) {
+		return data[0] | (static_cast<uint16_t>(data[1]) << 8);
+	}
+
+	static uint32_t read32(const uint8_t *data) {
+		return read16(data) | (static_cast<uint32_t>(read16(data + 2)) << 16);
+	}
+
+	static bool isSaved(const TimerTicket &ticket) {
+		return ticket.getId() != TimerTicket::NO_ID;
+	}
 }
 
 static const __FlashStringHelper *getUnitsString(TimerTicket::units_t unit) {
@@ -45,6 +74,15 @@ static const __FlashStringHelper *getUnitsString(TimerTicket::units_t unit) {
 	}
 }
 
+TimerTicket::TimerTicket()
+	: m_delayOffset(0)
+	, m_next_ticket(NULL)
+	, m_period(0)
+	, m_flags(static_cast<flags_t>(0))
+	, m_id(NO_ID)
+{
+}
+
 bool TimerTicket::isScheduled() const {
 	return isFlagEnabled(FLAG_TICKET_SCHEDULED);
 }
@@ -85,26 +123,25 @@ void TimerTicket::setScheduled(bool value) {
 	}
 }
 
-void TimerTicket::setDelayOffset(uint16_t delay, units_t units) {
+unsigned long TimerTicket::toMillis(uint16_t time, units_t units) {
 	switch (units) {
-	case MILLIS:
-		m_delayOffset = delay;
-		break;
 	case SECONDS:
-		m_delayOffset = SECONDS_TO_MILLIS(delay);
-		break;
+		return SECONDS_TO_MILLIS(time);
 	case MINUTES:
-		m_delayOffset = MINUTES_TO_MILLIS(delay);
-		break;
+		return MINUTES_TO_MILLIS(time);
 	case HOURS:
-		m_delayOffset = HOURS_TO_MILLIS(delay);
-		break;
+		return HOURS_TO_MILLIS(time);
 	case DAYS:
-		m_delayOffset = DAYS_TO_MILLIS(delay);
-		break;
+		return DAYS_TO_MILLIS(time);
+	default:
+		return time;
 	}
 }
 
+void TimerTicket::setDelayOffset(uint16_t delay, units_t units) {
+	m_delayOffset = toMillis(delay, units);
+}
+
 void TimerTicket::setPeriodUnits(units_t units) {
 	clearFlag(MASK_UNITS);
 	setFlag(static_cast<flags_t>(units << OFFSET_UNITS));
@@ -114,7 +151,14 @@ Timer::Timer()
 	: m_lastTick(0)
 	, m_firstTicket(NULL)
 	, m_running(false)
+	, m_loadSpreading(false)
 {
+	resetStats();
+}
+
+void Timer::resetStats() {
+	m_stats.peakDue = 0;
+	m_stats.peakDueSpread = 0;
 }
 
 void Timer::showTicketList(Print &p) const {
@@ -137,12 +181,23 @@ bool Timer::schedOneTime(TimerTicket &ticket, time_t delay, TimerTicket::units_t
 
 bool Timer::schedRepeat(TimerTicket &ticket, time_t delayOffset, TimerTicket::units_t delayUnits, time_t period, TimerTicket::units_t periodUnits) {
 	lock();
+	unscheduleTicket(ticket);
+	ticket.clearFlag(TimerTicket::FLAG_CALENDAR);
+	ticket.clearFlag(TimerTicket::FLAG_SPREAD);
 	ticket.setDelayOffset(delayOffset, delayUnits);
 	ticket.m_period = period;
 	ticket.setPeriodUnits(periodUnits);
 	ticket.m_delayOffset += elapsedTime(m_lastTick, millis());
-
-	addTicket(ticket);
+	if (m_loadSpreading && delayOffset == 0 && period != 0) {
+		unsigned long currentDelay = ticket.m_delayOffset;
+		ticket.setFlag(TimerTicket::FLAG_SPREAD);
+		spreadTickets(&ticket, 1, currentDelay);
+		addTicket(ticket);
+		rebalanceTickets(TimerTicket::toMillis(period, periodUnits), currentDelay);
+	} else {
+		addTicket(ticket);
+		updateNextTick(ticket);
+	}
 
 	unlock();
 	return true;
@@ -152,25 +207,332 @@ bool Timer::schedRepeat(TimerTicket &ticket, time_t period, TimerTicket::units_t
 	return schedRepeat(ticket, 0, TimerTicket::MILLIS, period, periodUnits);
 }
 
+void Timer::schedMillis(TimerTicket &ticket, const unsigned long &delay) {
+	lock();
+	unscheduleTicket(ticket);
+	ticket.clearFlag(TimerTicket::FLAG_CALENDAR);
+	ticket.clearFlag(TimerTicket::FLAG_SPREAD);
+	ticket.m_delayOffset = delay + elapsedTime(m_lastTick, millis());
+	ticket.m_period = 0;
+	ticket.setPeriodUnits(TimerTicket::MILLIS);
+
+	addTicket(ticket);
+	updateNextTick(ticket);
+
+	unlock();
+}
+
+bool Timer::unsched(TimerTicket &ticket) {
+	lock();
+	bool scheduled = ticket.isScheduled();
+	unscheduleTicket(ticket);
+	unlock();
+	return scheduled;
+}
+
+void Timer::unscheduleTicket(TimerTicket &ticket) {
+	if (!ticket.isScheduled()) {
+		return;
+	}
+
+	removeTicket(ticket);
+	if (ticket.isFlagEnabled(TimerTicket::FLAG_SPREAD)) {
+		ticket.clearFlag(TimerTicket::FLAG_SPREAD);
+		if (m_loadSpreading) {
+			rebalanceTickets(TimerTicket::toMillis(ticket.m_period, ticket.getPeriodUnits()),
+					elapsedTime(m_lastTick, millis()));
+		}
+	}
+}
+
+void Timer::updateNextTick(const TimerTicket &ticket) {
+	if (m_running && m_firstTicket == &ticket) {
+		setNextTickTimer(ticket.m_delayOffset);
+	}
+}
+
+bool Timer::schedCalendar(CalendarTicket &ticket, const CalendarRule &rule, const WallClock &clock) {
+	if (!clock.isSet()) {
+		return false;
+	}
+
+	lock();
+	unscheduleTicket(ticket);
+	ticket.clearFlag(TimerTicket::FLAG_SPREAD);
+	ticket.setFlag(TimerTicket::FLAG_CALENDAR);
+	ticket.m_period = 0;
+	ticket.setPeriodUnits(TimerTicket::MILLIS);
+	ticket.m_rule = &rule;
+	ticket.m_clock = &clock;
+
+	unsigned long currentMs = millis();
+	bool scheduled = rule.next(clock.at(currentMs), ticket.m_nextTime);
+	if (scheduled) {
+		ticket.m_delayOffset = ticket.getDelay(currentMs) + elapsedTime(m_lastTick, currentMs);
+		addTicket(ticket);
+		updateNextTick(ticket);
+	}
+
+	unlock();
+	return scheduled;
+}
+
+uint8_t Timer::schedBulk(const entry_t entries[], uint8_t count) {
+	lock();
+	for (uint8_t i = 0; i < count; i++) {
+		if (entries[i].ticket != NULL) {
+			unscheduleTicket(*entries[i].ticket);
+		}
+	}
+
+	// Tickets are linked with absolute delays, sorted and then converted to
+	// relative delays. With load spreading, repeated tickets without delay
+	// are linked apart, using their period as delay so they are sorted in
+	// groups with the same period.
+	TimerTicket *first = NULL, *spread = NULL;
+	uint8_t scheduled = 0;
+	for (uint8_t i = 0; i < count; i++) {
+		TimerTicket *ticket = entries[i].ticket;
+		if (ticket == NULL || ticket->isScheduled()) {
+			continue;
+		}
+
+		ticket->clearFlag(TimerTicket::FLAG_CALENDAR);
+		ticket->clearFlag(TimerTicket::FLAG_SPREAD);
+		ticket->m_period = entries[i].period;
+		ticket->setPeriodUnits(entries[i].periodUnits);
+		ticket->setScheduled(true);
+		if (m_loadSpreading && entries[i].delay == 0 && entries[i].period != 0) {
+			ticket->setFlag(TimerTicket::FLAG_SPREAD);
+			ticket->setDelayOffset(entries[i].period, entries[i].periodUnits);
+			ticket->m_next_ticket = spread;
+			spread = ticket;
+		} else {
+			ticket->setDelayOffset(entries[i].delay, entries[i].delayUnits);
+			ticket->m_next_ticket = first;
+			first = ticket;
+		}
+		scheduled++;
+	}
+
+	unsigned long elapsed = elapsedTime(m_lastTick, millis());
+	spread = sortTickets(spread);
+	while (spread != NULL) {
+		uint8_t groupCount = 1;
+		for (TimerTicket *ticket = spread->m_next_ticket;
+				ticket != NULL && ticket->m_delayOffset == spread->m_delayOffset;
+				ticket = ticket->m_next_ticket)
+		{
+			groupCount++;
+		}
+
+		// Group is merged at once, since spread delays count since last
+		// tick, and then evenly placed with scheduled tickets of its period.
+		unsigned long period = spread->m_delayOffset;
+		spreadTickets(spread, groupCount, elapsed);
+		TimerTicket *group = spread;
+		for (; groupCount > 1; groupCount--) {
+			spread = spread->m_next_ticket;
+		}
+		TimerTicket *last = spread;
+		spread = spread->m_next_ticket;
+		last->m_next_ticket = NULL;
+
+		group = sortTickets(group);
+		setRelativeDelays(group);
+		mergeTickets(group);
+		rebalanceTickets(period, elapsed);
+	}
+
+	first = sortTickets(first);
+	setRelativeDelays(first);
+
+	if (first != NULL) {
+		first->m_delayOffset += elapsed;
+		mergeTickets(first);
+	}
+
+	if (m_running && m_firstTicket != NULL) {
+		setNextTickTimer(m_firstTicket->m_delayOffset);
+	}
+	unlock();
+	return scheduled;
+}
+
+size_t Timer::getScheduleSize() {
+	lock();
+	size_t size = timer_detail::SCHEDULE_HEADER_SIZE;
+	for (TimerTicket *ticket = m_firstTicket; ticket != NULL; ticket = ticket->m_next_ticket) {
+		if (timer_detail::isSaved(*ticket) && !ticket->isFlagEnabled(TimerTicket::FLAG_CALENDAR)) {
+			size += timer_detail::SCHEDULE_RECORD_SIZE;
+		}
+	}
+	unlock();
+	return size;
+}
+
+size_t Timer::saveSchedule(uint8_t *data, size_t size) {
+	lock();
+	unsigned long elapsed = elapsedTime(m_lastTick, millis());
+
+	// Delays are saved relative to previous saved ticket, so skipped
+	// tickets add their delay to next one.
+	size_t n = timer_detail::SCHEDULE_HEADER_SIZE;
+	unsigned long skipped = 0;
+	uint8_t count = 0;
+	for (TimerTicket *ticket = m_firstTicket; ticket != NULL; ticket = ticket->m_next_ticket) {
+		unsigned long delay = ticket->m_delayOffset;
+		if (elapsed > delay) {
+			elapsed -= delay;
+			delay = 0;
+		} else {
+			delay -= elapsed;
+			elapsed = 0;
+		}
+
+		if (!timer_detail::isSaved(*ticket) || ticket->isFlagEnabled(TimerTicket::FLAG_CALENDAR)) {
+			skipped += delay;
+			continue;
+		}
+		if (n + timer_detail::SCHEDULE_RECORD_SIZE > size || count == 0xFF) {
+			unlock();
+			return 0;
+		}
+
+		uint8_t *record = data + n;
+		record[0] = ticket->m_id;
+		record[1] = static_cast<uint8_t>(ticket->getPeriodUnits());
+		timer_detail::write16(record + 2, ticket->m_period);
+		timer_detail::write32(record + 4, skipped + delay);
+		n += timer_detail::SCHEDULE_RECORD_SIZE;
+		skipped = 0;
+		count++;
+	}
+	unlock();
+
+	if (n > size) {
+		return 0;
+	}
+	data[0] = timer_detail::SCHEDULE_MAGIC;
+	data[1] = timer_detail::SCHEDULE_VERSION;
+	data[2] = count;
+	return n;
+}
+
+bool Timer::restoreSchedule(const uint8_t *data, size_t size,
+		TimerTicket *const tickets[], uint8_t count,
+		const unsigned long &elapsed)
+{
+	if (size < timer_detail::SCHEDULE_HEADER_SIZE
+			|| data[0] != timer_detail::SCHEDULE_MAGIC
+			|| data[1] != timer_detail::SCHEDULE_VERSION
+			|| size != timer_detail::SCHEDULE_HEADER_SIZE
+					+ data[2] * timer_detail::SCHEDULE_RECORD_SIZE)
+	{
+		return false;
+	}
+
+	lock();
+	const uint8_t *record = data + timer_detail::SCHEDULE_HEADER_SIZE;
+	for (uint8_t i = 0; i < data[2]; i++, record += timer_detail::SCHEDULE_RECORD_SIZE) {
+		uint8_t id = record[0];
+		if (id < count && tickets[id] != NULL) {
+			unscheduleTicket(*tickets[id]);
+		}
+	}
+
+	// Saved tickets are already sorted, so they are linked in the same order
+	// using delays relative to the first one.
+	TimerTicket *first = NULL;
+	TimerTicket **link = &first;
+	unsigned long delay = 0, previous = 0;
+	record = data + timer_detail::SCHEDULE_HEADER_SIZE;
+	for (uint8_t i = 0; i < data[2]; i++, record += timer_detail::SCHEDULE_RECORD_SIZE) {
+		delay += timer_detail::read32(record + 4);
+
+		uint8_t id = record[0];
+		TimerTicket *ticket = (id < count) ? tickets[id] : NULL;
+		if (ticket == NULL || ticket->isScheduled() || record[1] > TimerTicket::DAYS) {
+			continue;
+		}
+
+		unsigned long remaining = (delay > elapsed) ? delay - elapsed : 0;
+		ticket->clearFlag(TimerTicket::FLAG_CALENDAR);
+		ticket->clearFlag(TimerTicket::FLAG_SPREAD);
+		ticket->setPeriodUnits(static_cast<TimerTicket::units_t>(record[1]));
+		ticket->m_period = timer_detail::read16(record + 2);
+		ticket->m_delayOffset = remaining - previous;
+		ticket->setScheduled(true);
+		previous = remaining;
+
+		*link = ticket;
+		link = &ticket->m_next_ticket;
+	}
+	*link = NULL;
+
+	if (first != NULL) {
+		first->m_delayOffset += elapsedTime(m_lastTick, millis());
+		mergeTickets(first);
+	}
+
+	if (m_running && m_firstTicket != NULL) {
+		setNextTickTimer(m_firstTicket->m_delayOffset);
+	}
+	unlock();
+	return true;
+}
+
 void Timer::doTick(const unsigned long &currentMs) {
 	lock();
 	updateSchedule(currentMs);
+	uint8_t executed = 0;
 	while (m_firstTicket != NULL && m_firstTicket->m_delayOffset == 0) {
 		TimerTicket *ticket = m_firstTicket;
 		m_firstTicket = m_firstTicket->m_next_ticket;
+		ticket->m_next_ticket = NULL;
+		ticket->setScheduled(false);
 
-		if (ticket->m_delegate) {
+		// Calendar tickets wake up periodically to check the wall-clock, so
+		// they are only executed when their time has been reached.
+		// Call-backs executed in this tick can set the clock, so @a currentMs
+		// can be older than the clock and millis() must be read again.
+		CalendarTicket *calendar = NULL;
+		bool due = true;
+		if (ticket->isFlagEnabled(TimerTicket::FLAG_CALENDAR)) {
+			calendar = static_cast<CalendarTicket *>(ticket);
+			due = calendar->isDue(millis());
+		}
+
+		// Call-back can schedule its own ticket again, so it must be
+		// unlinked before calling it.
+		if (due && ticket->m_delegate) {
 			ticket->m_delegate();
 		}
+		if (due && executed < 0xFF) {
+			executed++;
+		}
 
-		ticket->m_next_ticket = NULL;
-		ticket->setScheduled(false);
-		if (ticket->m_period != 0) {
+		if (ticket->isScheduled()) {
+			continue;
+		}
+		if (calendar != NULL) {
+			unsigned long calendarMs = millis();
+			if (!due || calendar->advance(calendarMs)) {
+				ticket->m_delayOffset = calendar->getDelay(calendarMs)
+						+ elapsedTime(currentMs, calendarMs);
+				addTicket(*ticket);
+			}
+		} else if (ticket->m_period != 0) {
 			ticket->setDelayOffset(ticket->m_period, ticket->getPeriodUnits());
 			addTicket(*ticket);
 		}
 	}
 
+	uint8_t &peakDue = m_loadSpreading ? m_stats.peakDueSpread : m_stats.peakDue;
+	if (executed > peakDue) {
+		peakDue = executed;
+	}
+
 	if (m_firstTicket != NULL && m_running) {
 		setNextTickTimer(m_firstTicket->m_delayOffset/* - elapsedTime(currentMs, millis())*/);
 	}
@@ -218,6 +580,9 @@ void Timer::removeNextTicket(TimerTicket &ticket) {
 	TimerTicket *next = ticket.m_next_ticket;
 	if (next != NULL) {
 		ticket.m_next_ticket = next->m_next_ticket;
+		if (next->m_next_ticket != NULL) {
+			next->m_next_ticket->m_delayOffset += next->m_delayOffset;
+		}
 		next->m_next_ticket = NULL;
 		next->clearFlag(TimerTicket::FLAG_TICKET_SCHEDULED);
 	}
@@ -225,7 +590,11 @@ void Timer::removeNextTicket(TimerTicket &ticket) {
 
 void Timer::removeTicket(TimerTicket &ticket) {
 	if (&ticket == m_firstTicket) {
-		m_firstTicket = m_firstTicket->m_next_ticket;
+		m_firstTicket = ticket.m_next_ticket;
+		if (m_firstTicket != NULL) {
+			m_firstTicket->m_delayOffset += ticket.m_delayOffset;
+		}
+		ticket.m_next_ticket = NULL;
 	} else {
 		TimerTicket *previous = findPreviousTicket(ticket);
 		if (previous != NULL) {
@@ -236,10 +605,6 @@ void Timer::removeTicket(TimerTicket &ticket) {
 }
 
 void Timer::addTicket(TimerTicket &ticket) {
-	if (ticket.isScheduled()) {
-		removeTicket(ticket);
-	}
-
 	ticket.setScheduled(true);
 	if (m_firstTicket == NULL) {
 		m_firstTicket = &ticket;
@@ -268,12 +633,261 @@ void Timer::addTicket(TimerTicket &ticket) {
 				next = current->m_next_ticket;
 			}
 
+			ticket.m_delayOffset -= current->m_delayOffset;
 			ticket.m_next_ticket = NULL;
 			current->m_next_ticket = &ticket;
 		}
 	}
 }
 
+void Timer::mergeTickets(TimerTicket *tickets) {
+	TimerTicket *current = m_firstTicket;
+	unsigned long currentDelay = (current != NULL) ? current->m_delayOffset : 0;
+	unsigned long ticketsDelay = (tickets != NULL) ? tickets->m_delayOffset : 0;
+	unsigned long previous = 0;
+
+	TimerTicket **link = &m_firstTicket;
+	while (current != NULL || tickets != NULL) {
+		TimerTicket *ticket;
+		unsigned long delay;
+		if (tickets == NULL || (current != NULL && currentDelay <= ticketsDelay)) {
+			ticket = current;
+			delay = currentDelay;
+			current = current->m_next_ticket;
+			if (current != NULL) {
+				currentDelay += current->m_delayOffset;
+			}
+		} else {
+			ticket = tickets;
+			delay = ticketsDelay;
+			tickets = tickets->m_next_ticket;
+			if (tickets != NULL) {
+				ticketsDelay += tickets->m_delayOffset;
+			}
+		}
+
+		ticket->m_delayOffset = delay - previous;
+		previous = delay;
+		*link = ticket;
+		link = &ticket->m_next_ticket;
+	}
+	*link = NULL;
+}
+
+TimerTicket *Timer::sortTickets(TimerTicket *tickets) {
+	// Bottom-up merge sort by delay. Each pass merges pairs of sorted runs
+	// of @a width tickets until only one run is left.
+	if (tickets == NULL) {
+		return NULL;
+	}
+
+	for (uint16_t width = 1; ; width *= 2) {
+		TimerTicket *left = tickets, *last = NULL;
+		uint8_t merges = 0;
+		tickets = NULL;
+
+		while (left != NULL) {
+			merges++;
+			TimerTicket *right = left;
+			uint16_t leftSize = 0, rightSize = width;
+			while (leftSize < width && right != NULL) {
+				leftSize++;
+				right = right->m_next_ticket;
+			}
+
+			while (leftSize > 0 || (rightSize > 0 && right != NULL)) {
+				TimerTicket *ticket;
+				if (leftSize != 0 && (rightSize == 0 || right == NULL
+						|| left->m_delayOffset <= right->m_delayOffset))
+				{
+					ticket = left;
+					left = left->m_next_ticket;
+					leftSize--;
+				} else {
+					ticket = right;
+					right = right->m_next_ticket;
+					rightSize--;
+				}
+
+				if (last != NULL) {
+					last->m_next_ticket = ticket;
+				} else {
+					tickets = ticket;
+				}
+				last = ticket;
+			}
+			left = right;
+		}
+		last->m_next_ticket = NULL;
+
+		if (merges <= 1) {
+			return tickets;
+		}
+	}
+}
+
+void Timer::spreadTickets(TimerTicket *tickets, uint8_t count, const unsigned long &currentDelay) const {
+	// Find the largest gap between executions of scheduled tickets with the
+	// same period, including the one between the last and the first
+	// execution of next period.
+	unsigned long period = TimerTicket::toMillis(tickets->m_period, tickets->getPeriodUnits());
+	unsigned long delay = 0, first = 0, previous = 0;
+	unsigned long gapStart = 0, gapLength = 0;
+	bool found = false;
+	for (const TimerTicket *current = m_firstTicket; current != NULL; current = current->m_next_ticket) {
+		delay += current->m_delayOffset;
+		if (!isSpreadTicket(*current, period)) {
+			continue;
+		}
+
+		if (!found) {
+			first = delay;
+			found = true;
+		} else if (delay - previous > gapLength) {
+			gapStart = previous;
+			gapLength = delay - previous;
+		}
+		previous = delay;
+	}
+
+	// Without scheduled tickets in the period, first ticket is executed at
+	// once and the rest evenly along the period. Otherwise tickets are
+	// evenly placed inside the gap, excluding its ends.
+	uint8_t slots = count, slot = 0;
+	if (!found) {
+		gapStart = currentDelay;
+		gapLength = period;
+	} else {
+		if (previous - first < period && first + period - previous > gapLength) {
+			gapStart = previous;
+			gapLength = first + period - previous;
+		}
+		slots = count + 1;
+		slot = 1;
+	}
+
+	for (TimerTicket *ticket = tickets; count > 0; ticket = ticket->m_next_ticket, count--, slot++) {
+		delay = gapStart + gapLength / slots * slot + gapLength % slots * slot / slots;
+
+		// Move delay to the next period starting at current time
+		if (delay >= currentDelay) {
+			delay = currentDelay + (delay - currentDelay) % period;
+		} else {
+			delay = currentDelay + (period - (currentDelay - delay) % period) % period;
+		}
+		ticket->m_delayOffset = delay;
+	}
+}
+
+bool Timer::isSpreadTicket(const TimerTicket &ticket, const unsigned long &period) {
+	return ticket.isFlagEnabled(TimerTicket::FLAG_SPREAD)
+			&& ticket.m_period != 0
+			&& TimerTicket::toMillis(ticket.m_period, ticket.getPeriodUnits()) == period;
+}
+
+void Timer::rebalanceTickets(const unsigned long &period, const unsigned long &currentDelay) {
+	// Unlink tickets spread along @a period, keeping delays of the rest
+	TimerTicket *group = NULL;
+	TimerTicket **groupLink = &group;
+	TimerTicket **link = &m_firstTicket;
+	unsigned long delay = 0, removed = 0;
+	uint8_t count = 0;
+	while (*link != NULL) {
+		TimerTicket *ticket = *link;
+		delay += ticket->m_delayOffset;
+		if (isSpreadTicket(*ticket, period) && count < 0xFF) {
+			*link = ticket->m_next_ticket;
+			removed += ticket->m_delayOffset;
+			ticket->m_delayOffset = delay;
+			*groupLink = ticket;
+			groupLink = &ticket->m_next_ticket;
+			count++;
+		} else {
+			ticket->m_delayOffset += removed;
+			removed = 0;
+			link = &ticket->m_next_ticket;
+		}
+	}
+	*groupLink = NULL;
+
+	if (group != NULL) {
+		// Place them evenly along the period, starting at the first one.
+		// Places already elapsed are moved to next period.
+		unsigned long first = group->m_delayOffset;
+		uint8_t slot = 0;
+		for (TimerTicket *ticket = group; ticket != NULL; ticket = ticket->m_next_ticket, slot++) {
+			delay = first + period / count * slot + period % count * slot / count;
+			if (delay < currentDelay) {
+				delay += period;
+			}
+			ticket->m_delayOffset = delay;
+		}
+		group = sortTickets(group);
+		setRelativeDelays(group);
+		mergeTickets(group);
+	}
+
+	if (m_running && m_firstTicket != NULL) {
+		setNextTickTimer(m_firstTicket->m_delayOffset);
+	}
+}
+
+void Timer::setRelativeDelays(TimerTicket *tickets) {
+	unsigned long previous = 0;
+	for (TimerTicket *ticket = tickets; ticket != NULL; ticket = ticket->m_next_ticket) {
+		unsigned long delay = ticket->m_delayOffset;
+		ticket->m_delayOffset -= previous;
+		previous = delay;
+	}
+}
+
+Timer::stats_t Timer::getScheduleStats() {
+	lock();
+	stats_t stats = { 0, 0 };
+	TimerTicket *ticket = m_firstTicket;
+	while (ticket != NULL) {
+		// Tickets with the same execution time are consecutive, all but the
+		// first one with a zero delay.
+		uint16_t due = 0, unspread = 0;
+		do {
+			due++;
+			if (!ticket->isFlagEnabled(TimerTicket::FLAG_SPREAD)) {
+				unspread++;
+			} else {
+				unspread += countUnspreadTickets(*ticket);
+			}
+			ticket = ticket->m_next_ticket;
+		} while (ticket != NULL && ticket->m_delayOffset == 0);
+
+		if (due > stats.peakDueSpread) {
+			stats.peakDueSpread = (due < 0xFF) ? due : 0xFF;
+		}
+		if (unspread > stats.peakDue) {
+			stats.peakDue = (unspread < 0xFF) ? unspread : 0xFF;
+		}
+	}
+	unlock();
+	return stats;
+}
+
+uint8_t Timer::countUnspreadTickets(const TimerTicket &ticket) const {
+	// Without load spreading, tickets of a period would be executed with the
+	// first one of them.
+	unsigned long period = TimerTicket::toMillis(ticket.m_period, ticket.getPeriodUnits());
+	uint8_t count = 0;
+	for (const TimerTicket *current = m_firstTicket; current != NULL; current = current->m_next_ticket) {
+		if (isSpreadTicket(*current, period)) {
+			if (count == 0 && current != &ticket) {
+				return 0;
+			}
+			if (count < 0xFF) {
+				count++;
+			}
+		}
+	}
+	return count;
+}
+
 void Timer::updateSchedule(const unsigned long &newTick) {
 	unsigned long elapsed = elapsedTime(m_lastTick, newTick);
 
@@ -282,8 +896,8 @@ void Timer::updateSchedule(const unsigned long &newTick) {
 			ticket->m_delayOffset -= elapsed;
 			break;
 		} else {
-			ticket->m_delayOffset = 0;
 			elapsed -= ticket->m_delayOffset;
+			ticket->m_delayOffset = 0;
 		}
 	}
 
@@ -0,0 +1,59 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @section LICENSE                                                         ///
+///                                                                          ///
+///        Distributed under the Boost Software License, Version 1.0.        ///
+///             (See accompanying file LICENSE_1_0.txt or copy at            ///
+///                  http://www.boost.org/LICENSE_1_0.txt)                   ///
+///                                                                          ///
+/// @file                                                                    ///
+/// @author  Alejandro Morell Garcia                                         ///
+/// @version 1.0                                                             ///
+////////////////////////////////////////////////////////////////////////////////
+#include "util/WallClock.h"
+#include <util/time.h>
+#include <Arduino.h>
+#include <limits.h>
+
+
+namespace util {
+
+WallClock::WallClock()
+	: m_epoch(0)
+	, m_setMs(0)
+	, m_set(false)
+{
+}
+
+void WallClock::set(epoch_t seconds) {
+	m_setMs = millis();
+	m_epoch = seconds;
+	m_set = true;
+}
+
+WallClock::epoch_t WallClock::now() const {
+	return at(millis());
+}
+
+WallClock::epoch_t WallClock::at(const unsigned long &ms) const {
+	return m_epoch + elapsedTime(m_setMs, ms) / 1000UL;
+}
+
+unsigned long WallClock::millisUntil(epoch_t time, const unsigned long &ms) const {
+	if (time <= m_epoch) {
+		return 0;
+	}
+
+	epoch_t seconds = time - m_epoch;
+	unsigned long target = ULONG_MAX;
+	if (seconds < ULONG_MAX / 1000UL) {
+		target = seconds * 1000UL;
+	}
+
+	unsigned long elapsed = elapsedTime(m_setMs, ms);
+	if (target <= elapsed) {
+		return 0;
+	}
+	return target - elapsed;
+}
+
+} // namespace util